@@ -0,0 +1,174 @@
+#ifndef DCP_SLAVE_IO_H_
+#define DCP_SLAVE_IO_H_
+
+#include <dcp/logic/DcpManagerSlave.hpp>
+#include <dcp/xml/DcpSlaveDescriptionWriter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "dcp-variables.hpp"
+
+//Parte lato slave della dichiarazione degli I/O (vedi dcp-variables.hpp).
+//Dalla lista di variabili vengono generati la SlaveDescription, il file xml e gli accessor tipizzati,
+//i cui puntatori vengono risolti una sola volta nel configure.
+//
+//Esempio:
+//  typedef DcpSlaveIO<Pos> IO;
+//  IO::describe(slaveDescription);   //in getSlaveDescription
+//  io.bind(manager);                 //in configure
+//  io.get<Pos>().setString("...");   //in doStep
+//
+//Una variabile puo' definire facoltativamente
+//  static void describe(std::shared_ptr<Output_t>& c)            (output)
+//  static void describe(std::shared_ptr<CommonCausality_t>& c)   (input)
+//per impostare start, maxSize ecc.
+
+//Tipi numerici: il valore vive nel buffer del DcpManagerSlave, l'handle e' il puntatore grezzo
+template<typename T>
+struct SlaveIOTypeTraits {
+    typedef T* handle_t;
+    typedef T& reference_t;
+    typedef const T& const_reference_t;
+
+    static handle_t bindInput(DcpManagerSlave* manager, uint32_t vr) { return manager->getInput<T*>(vr); }
+    static handle_t bindOutput(DcpManagerSlave* manager, uint32_t vr) { return manager->getOutput<T*>(vr); }
+    static reference_t deref(handle_t& handle) { return *handle; }
+    static const_reference_t deref(const handle_t& handle) { return *handle; }
+
+    static std::shared_ptr<CommonCausality_t> makeInput() { return make_CommonCausality_ptr<T>(); }
+    static std::shared_ptr<Output_t> makeOutput() { return make_Output_ptr<T>(); }
+};
+
+//Stringhe (solo output, vedi SlaveVariable): DcpString incapsula il buffer char* restituito dal manager
+template<>
+struct SlaveIOTypeTraits<DcpString> {
+    typedef std::unique_ptr<DcpString> handle_t;
+    typedef DcpString& reference_t;
+    typedef const DcpString& const_reference_t;
+
+    static handle_t bindOutput(DcpManagerSlave* manager, uint32_t vr) {
+        return handle_t(new DcpString(manager->getOutput<char*>(vr)));
+    }
+    static reference_t deref(handle_t& handle) { return *handle; }
+    static const_reference_t deref(const handle_t& handle) { return *handle; }
+
+    static std::shared_ptr<Output_t> makeOutput() { return make_Output_String_ptr(); }
+};
+
+namespace slave_io_detail {
+
+    template<typename V, typename P, typename = void>
+    struct HasDescribe : std::false_type {};
+
+    template<typename V, typename P>
+    struct HasDescribe<V, P, decltype(V::describe(std::declval<P&>()), void())> : std::true_type {};
+
+    template<typename V, typename... Vars>
+    struct IndexOf;
+
+    template<typename V, typename... Vars>
+    struct IndexOf<V, V, Vars...> : std::integral_constant<std::size_t, 0> {};
+
+    template<typename V, typename First, typename... Vars>
+    struct IndexOf<V, First, Vars...>
+            : std::integral_constant<std::size_t, 1 + IndexOf<V, Vars...>::value> {};
+
+    template<typename V>
+    struct IndexOf<V> {
+        static_assert(sizeof(V) == 0, "Variabile non dichiarata in questo DcpSlaveIO");
+    };
+
+    constexpr bool uniqueValueReferences(const uint32_t* vrs, std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = i + 1; j < n; j++) {
+                if (vrs[i] == vrs[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename... Vars>
+    struct ValueReferences {
+        static constexpr uint32_t values[sizeof...(Vars) + 1] = {Vars::vr..., 0};
+    };
+}
+
+template<typename... Vars>
+class DcpSlaveIO {
+public:
+    static_assert(slave_io_detail::uniqueValueReferences(
+                          slave_io_detail::ValueReferences<Vars...>::values, sizeof...(Vars)),
+                  "Value reference duplicata nella dichiarazione degli I/O");
+
+    //Aggiunge tutte le variabili dichiarate alla SlaveDescription, nell'ordine della lista
+    static void describe(SlaveDescription_t& slaveDescription) {
+        (addVariable<Vars>(slaveDescription), ...);
+    }
+
+    static void writeXml(const SlaveDescription_t& slaveDescription, const char* path) {
+        writeDcpSlaveDescription(slaveDescription, path);
+    }
+
+    //Risolve i puntatori ai buffer del manager, da chiamare nel configure
+    void bind(DcpManagerSlave* manager) {
+        bindAll(manager, std::index_sequence_for<Vars...>{});
+    }
+
+    template<typename V>
+    typename SlaveIOTypeTraits<typename V::type>::reference_t get() {
+        return SlaveIOTypeTraits<typename V::type>::deref(
+                std::get<slave_io_detail::IndexOf<V, Vars...>::value>(handles));
+    }
+
+    template<typename V>
+    typename SlaveIOTypeTraits<typename V::type>::const_reference_t get() const {
+        return SlaveIOTypeTraits<typename V::type>::deref(
+                std::get<slave_io_detail::IndexOf<V, Vars...>::value>(handles));
+    }
+
+private:
+    template<typename V>
+    static void addVariable(SlaveDescription_t& slaveDescription) {
+        typedef SlaveIOTypeTraits<typename V::type> Traits;
+        if constexpr (V::causality == SlaveIOCausality::Input) {
+            std::shared_ptr<CommonCausality_t> caus = Traits::makeInput();
+            if constexpr (slave_io_detail::HasDescribe<V, std::shared_ptr<CommonCausality_t>>::value) {
+                V::describe(caus);
+            }
+            slaveDescription.Variables.push_back(make_Variable_input(V::name, V::vr, caus));
+        } else {
+            std::shared_ptr<Output_t> caus = Traits::makeOutput();
+            if constexpr (slave_io_detail::HasDescribe<V, std::shared_ptr<Output_t>>::value) {
+                V::describe(caus);
+            }
+            slaveDescription.Variables.push_back(make_Variable_output(V::name, V::vr, caus));
+        }
+    }
+
+    template<typename V>
+    static typename SlaveIOTypeTraits<typename V::type>::handle_t bindVariable(DcpManagerSlave* manager) {
+        typedef SlaveIOTypeTraits<typename V::type> Traits;
+        if constexpr (V::causality == SlaveIOCausality::Input) {
+            return Traits::bindInput(manager, V::vr);
+        } else {
+            return Traits::bindOutput(manager, V::vr);
+        }
+    }
+
+    template<std::size_t... I>
+    void bindAll(DcpManagerSlave* manager, std::index_sequence<I...>) {
+        ((std::get<I>(handles) = bindVariable<Vars>(manager)), ...);
+    }
+
+    std::tuple<typename SlaveIOTypeTraits<typename Vars::type>::handle_t...> handles;
+};
+
+#endif /* DCP_SLAVE_IO_H_ */
@@ -0,0 +1,49 @@
+#ifndef DCP_VARIABLES_H_
+#define DCP_VARIABLES_H_
+
+#include <dcp/helper/Helper.hpp>
+#include <dcp/xml/DcpSlaveDescriptionElements.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+//Dichiarazione a compile-time delle variabili di uno slave.
+//Ogni variabile viene dichiarata una sola volta come tipo (nome, value reference, tipo, causalita'):
+//  struct Pos : SlaveOutput<1, DcpString> { static constexpr const char* name = "pos"; };
+//Questo header non dipende dal DcpManagerSlave e puo' essere incluso anche dal master
+//per la configurazione; binding e generazione della descrizione sono in dcp-slave-io.hpp.
+//Richiede C++17.
+
+enum class SlaveIOCausality { Input, Output };
+
+template<typename T> struct SlaveIODataType;
+template<> struct SlaveIODataType<uint8_t> { static constexpr DcpDataType value = DcpDataType::uint8; };
+template<> struct SlaveIODataType<uint16_t> { static constexpr DcpDataType value = DcpDataType::uint16; };
+template<> struct SlaveIODataType<uint32_t> { static constexpr DcpDataType value = DcpDataType::uint32; };
+template<> struct SlaveIODataType<uint64_t> { static constexpr DcpDataType value = DcpDataType::uint64; };
+template<> struct SlaveIODataType<int8_t> { static constexpr DcpDataType value = DcpDataType::int8; };
+template<> struct SlaveIODataType<int16_t> { static constexpr DcpDataType value = DcpDataType::int16; };
+template<> struct SlaveIODataType<int32_t> { static constexpr DcpDataType value = DcpDataType::int32; };
+template<> struct SlaveIODataType<int64_t> { static constexpr DcpDataType value = DcpDataType::int64; };
+template<> struct SlaveIODataType<float32_t> { static constexpr DcpDataType value = DcpDataType::float32; };
+template<> struct SlaveIODataType<float64_t> { static constexpr DcpDataType value = DcpDataType::float64; };
+template<> struct SlaveIODataType<DcpString> { static constexpr DcpDataType value = DcpDataType::string; };
+
+template<uint32_t VR, typename T, SlaveIOCausality C>
+struct SlaveVariable {
+    typedef T type;
+    static constexpr uint32_t vr = VR;
+    static constexpr SlaveIOCausality causality = C;
+    static constexpr DcpDataType dataType = SlaveIODataType<T>::value;
+
+    static_assert(!(C == SlaveIOCausality::Input && std::is_same<T, DcpString>::value),
+                  "Input di tipo stringa non supportati: dichiarare la variabile come SlaveOutput");
+};
+
+template<uint32_t VR, typename T>
+using SlaveInput = SlaveVariable<VR, T, SlaveIOCausality::Input>;
+
+template<uint32_t VR, typename T>
+using SlaveOutput = SlaveVariable<VR, T, SlaveIOCausality::Output>;
+
+#endif /* DCP_VARIABLES_H_ */
@@ -0,0 +1,263 @@
+#ifndef PHASE_PROFILER_H_
+#define PHASE_PROFILER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Profiler in-process a fasi, pensato per misurare la suddivisione del tempo di uno step.
+//Le fasi vengono registrate una volta (registerPhase) e misurate con PhaseProfiler::Scope.
+//Ogni thread scrive in un proprio buffer senza lock: da attivo uno Scope costa due letture
+//del clock e un push_back, da disattivato una lettura atomica.
+//A fine simulazione si possono esportare un trace JSON per chrome://tracing (o Perfetto)
+//e una tabella riassuntiva per fase. Export e reset leggono i buffer degli altri thread e vanno
+//chiamati quando nessuno Scope e' attivo (es. nella callback di stop, sullo stesso thread del doStep).
+//Il profiler e' disattivato di default e puo' essere attivato/disattivato a runtime (setEnabled o segnale).
+class PhaseProfiler {
+public:
+    typedef uint16_t phase_t;
+    typedef std::chrono::steady_clock clock_type;
+
+    static const phase_t MAX_PHASES = 64;
+    //Restituito da registerPhase a tabella piena, gli Scope con questa fase non misurano nulla
+    static const phase_t INVALID_PHASE = UINT16_MAX;
+    //Oltre questo numero di eventi per thread il trace viene troncato, il riassunto resta completo
+    static const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    static PhaseProfiler& instance() {
+        static PhaseProfiler profiler;
+        return profiler;
+    }
+
+    phase_t registerPhase(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (phase_t i = 0; i < phaseNames.size(); i++) {
+            if (phaseNames[i] == name) {
+                return i;
+            }
+        }
+        if (phaseNames.size() >= MAX_PHASES) {
+            std::cerr << "PhaseProfiler: troppe fasi registrate, " << name << " ignorata" << std::endl;
+            return INVALID_PHASE;
+        }
+        phaseNames.push_back(name);
+        return static_cast<phase_t>(phaseNames.size() - 1);
+    }
+
+    static void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    //Installa un handler che alterna attivazione/disattivazione alla ricezione del segnale (es. SIGUSR1)
+    static void installToggleSignal(int signal) {
+        std::signal(signal, &PhaseProfiler::toggle);
+    }
+
+    //Abilita il profiler se la variabile d'ambiente e' definita, il valore e' il percorso del trace
+    bool enableFromEnv(const char* variable) {
+        const char* value = std::getenv(variable);
+        if (value == nullptr || *value == '\0') {
+            return false;
+        }
+        tracePath = value;
+        setEnabled(true);
+        return true;
+    }
+
+    const std::string& getTracePath() const { return tracePath; }
+
+    //Misura la durata del blocco in cui vive
+    class Scope {
+    public:
+        explicit Scope(phase_t phase) : phase(phase), active(phase != INVALID_PHASE && PhaseProfiler::isEnabled()) {
+            if (active) {
+                start = clock_type::now();
+            }
+        }
+
+        ~Scope() {
+            if (active) {
+                PhaseProfiler::instance().record(phase, start, clock_type::now());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        phase_t phase;
+        bool active;
+        clock_type::time_point start;
+    };
+
+    void record(phase_t phase, clock_type::time_point start, clock_type::time_point end) {
+        ThreadBuffer& buffer = threadBuffer();
+        const int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch).count();
+        const int64_t durNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        PhaseStats& stats = buffer.stats[phase];
+        stats.count++;
+        stats.totalNs += durNs;
+        stats.maxNs = std::max(stats.maxNs, durNs);
+        if (buffer.events.size() < MAX_TRACE_EVENTS) {
+            buffer.events.push_back({phase, startNs, durNs});
+        }
+    }
+
+    //Vero se almeno una fase e' stata misurata, anche se il profiler e' stato poi disattivato
+    bool hasRecords() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& buffer : buffers) {
+            for (const auto& stats : buffer->stats) {
+                if (stats.count > 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    //Formato Chrome trace-event: un evento "X" (complete) per ogni fase misurata
+    bool writeChromeTrace(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "PhaseProfiler: impossibile scrivere " << path << std::endl;
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        char number[64];
+        for (const auto& buffer : buffers) {
+            for (const auto& event : buffer->events) {
+                out << (first ? "\n" : ",\n");
+                first = false;
+                out << "{\"name\":\"";
+                writeEscaped(out, phaseNames[event.phase]);
+                std::snprintf(number, sizeof(number), "%.3f", event.startNs / 1000.0);
+                out << "\",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                    << ",\"ts\":" << number;
+                std::snprintf(number, sizeof(number), "%.3f", event.durNs / 1000.0);
+                out << ",\"dur\":" << number << "}";
+            }
+        }
+        out << "\n]}\n";
+        return true;
+    }
+
+    //Tabella per fase: chiamate, tempo totale, medio e massimo.
+    //La percentuale e' relativa alla fase con il totale piu' alto, tipicamente quella che racchiude lo step intero
+    void printSummary(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<PhaseStats> total(phaseNames.size());
+        for (const auto& buffer : buffers) {
+            for (size_t i = 0; i < total.size(); i++) {
+                total[i].count += buffer->stats[i].count;
+                total[i].totalNs += buffer->stats[i].totalNs;
+                total[i].maxNs = std::max(total[i].maxNs, buffer->stats[i].maxNs);
+            }
+        }
+        int64_t grandTotalNs = 0;
+        for (const auto& stats : total) {
+            grandTotalNs = std::max(grandTotalNs, stats.totalNs);
+        }
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-24s %10s %12s %12s %12s %7s",
+                      "Fase", "Chiamate", "Totale(ms)", "Medio(us)", "Max(us)", "%");
+        out << line << std::endl;
+        for (size_t i = 0; i < total.size(); i++) {
+            const PhaseStats& stats = total[i];
+            if (stats.count == 0) {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "%-24s %10llu %12.3f %12.3f %12.3f %6.1f%%",
+                          phaseNames[i].c_str(),
+                          static_cast<unsigned long long>(stats.count),
+                          stats.totalNs / 1e6,
+                          stats.totalNs / 1e3 / stats.count,
+                          stats.maxNs / 1e3,
+                          grandTotalNs > 0 ? 100.0 * stats.totalNs / grandTotalNs : 0.0);
+            out << line << std::endl;
+        }
+    }
+
+    //Svuota eventi e statistiche mantenendo le fasi registrate, da chiamare a profiler quiescente
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& buffer : buffers) {
+            buffer->events.clear();
+            std::fill(buffer->stats, buffer->stats + MAX_PHASES, PhaseStats());
+        }
+        epoch = clock_type::now();
+    }
+
+private:
+    struct Event {
+        phase_t phase;
+        int64_t startNs;
+        int64_t durNs;
+    };
+
+    struct PhaseStats {
+        uint64_t count = 0;
+        int64_t totalNs = 0;
+        int64_t maxNs = 0;
+    };
+
+    //Scritto solo dal thread proprietario, letto da export/reset a profiler quiescente
+    struct ThreadBuffer {
+        uint32_t tid;
+        std::vector<Event> events;
+        PhaseStats stats[MAX_PHASES];
+    };
+
+    PhaseProfiler() : epoch(clock_type::now()) {}
+
+    //Eseguito nel signal handler: solo operazioni atomiche lock-free
+    static void toggle(int) {
+        enabled.store(!enabled.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    ThreadBuffer& threadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.emplace_back(new ThreadBuffer());
+            buffer = buffers.back().get();
+            buffer->tid = static_cast<uint32_t>(buffers.size());
+            buffer->events.reserve(4096);
+        }
+        return *buffer;
+    }
+
+    static void writeEscaped(std::ostream& out, const std::string& str) {
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                out << '\\';
+            }
+            out << c;
+        }
+    }
+
+    static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "Il toggle da signal handler richiede atomic<bool> lock-free");
+    inline static std::atomic<bool> enabled{false};
+
+    clock_type::time_point epoch;
+    std::string tracePath = "phase-trace.json";
+
+    std::mutex mutex;
+    std::vector<std::string> phaseNames;
+    //I buffer restano vivi fino alla fine del processo, anche se il thread termina prima
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+#endif /* PHASE_PROFILER_H_ */
@@ -14,6 +14,10 @@
 #include <dcp/logic/DcpManagerMaster.hpp>
 #include <dcp/log/OstreamLog.hpp>
 #include <thread>
+#include <type_traits>
+
+#include "../slaveSumo/sumo-io.hpp"
+#include "../slaveGeneric/rng-io.hpp"
 
 
 class MasterModel {
@@ -86,27 +90,27 @@ private:
             //Configurazione degli scope per una Data PDU identificato dal data_id (vr nel caso nostro)
             //Per maggiori dettagli sui tipi di DcpScope e loro funzionamento guardare "DCP Specification v1" Sezione 3.4.6 "Scope"
 
-            manager->CFG_scope(1, 1, DcpScope::Initialization_Run_NonRealTime);
+            manager->CFG_scope(1, POS_DATA_ID, DcpScope::Initialization_Run_NonRealTime);
             std::cout << "SlaveID=1 VR=1 Scope: Initialization_Run_NRT" << std::endl;
-            manager->CFG_scope(1, 2, DcpScope::Initialization_Run_NonRealTime);
+            manager->CFG_scope(1, SEM_DATA_ID, DcpScope::Initialization_Run_NonRealTime);
             std::cout << "SlaveID=1 VR=2 Scope: Initialization_Run_NRT" << std::endl;
 
             //Configurazione degli input e output in base al loro data_id e posizione nel PDU_input_output
-            manager->CFG_output(1, 1, 0, slaveDescription1->Variables.at(0).valueReference);
+            manager->CFG_output(1, POS_DATA_ID, 0, SumoPos::vr);
             std::cout << "SlaveID=1 OUTPUT Value Reference VR=1" << std::endl;
-            manager->CFG_input(1, 2, 0, slaveDescription1->Variables.at(1).valueReference, DcpDataType::uint8);
+            manager->CFG_input(1, SEM_DATA_ID, 0, SumoSemValue::vr, RngSemVal::dataType);
             std::cout << "SlaveID=1 INPUT Value Reference VR=2" << std::endl;
 
-            manager->CFG_steps(1, 1, 1);
+            manager->CFG_steps(1, POS_DATA_ID, 1);
             std::cout << "SlaveID=1 CFG Steps" << std::endl;
             manager->CFG_time_res(1, slaveDescription1->TimeRes.resolutions.front().numerator,
                                   slaveDescription1->TimeRes.resolutions.front().denominator);
             std::cout << "SlaveID=1 CFG Time Resolution" << std::endl;
             //Informazioni di network di source e target per lo scambio di dati tra gli slave
-            manager->CFG_source_network_information_UDP(1, 2, asio::ip::address_v4::from_string(
+            manager->CFG_source_network_information_UDP(1, SEM_DATA_ID, asio::ip::address_v4::from_string(
                 *slaveDescription1->TransportProtocols.UDP_IPv4->Control->host).to_ulong(), port1);
             std::cout << "SlaveID=1 Source Network Informations" << std::endl;
-            manager->CFG_target_network_information_UDP(1, 1, asio::ip::address_v4::from_string(
+            manager->CFG_target_network_information_UDP(1, POS_DATA_ID, asio::ip::address_v4::from_string(
                 *slaveDescription2->TransportProtocols.UDP_IPv4->Control->host).to_ulong(), port2); //RICORDA DI EDITARE MATTEO
             std::cout << "SlaveID=1 Target Network Informations" << std::endl;
 
@@ -119,21 +123,21 @@ private:
         {
             std::cout << "Configure Slave 2" << std::endl;
             receivedAcks[2] = 0;
-            manager->CFG_scope(2, 2, DcpScope::Initialization_Run_NonRealTime);
+            manager->CFG_scope(2, SEM_DATA_ID, DcpScope::Initialization_Run_NonRealTime);
             std::cout << "SlaveID=2 VR=2 Scope: Initialization_Run_NRT" << std::endl;
 
             // inuput dataId = 1, output dataId = 2
-            manager->CFG_output(2, 2, 0, slaveDescription2->Variables.at(0).valueReference);
+            manager->CFG_output(2, SEM_DATA_ID, 0, RngSemVal::vr);
             std::cout << "SlaveID=2 VR=2 OUTPUT Value Reference VR=2" << std::endl;
-            manager->CFG_steps(2, 2, 1);
+            manager->CFG_steps(2, SEM_DATA_ID, 1);
             std::cout << "SlaveID=2 CFG Steps" << std::endl;
             manager->CFG_time_res(2, slaveDescription1->TimeRes.resolutions.front().numerator,
                                   slaveDescription1->TimeRes.resolutions.front().denominator);
             std::cout << "SlaveID=2 CFG Time Resolutions" << std::endl;
-            manager->CFG_source_network_information_UDP(2, 1, asio::ip::address_v4::from_string(
+            manager->CFG_source_network_information_UDP(2, POS_DATA_ID, asio::ip::address_v4::from_string(
                 *slaveDescription2->TransportProtocols.UDP_IPv4->Control->host).to_ulong(), port2);
             std::cout << "SlaveID=2 Source Network Informations" << std::endl;
-            manager->CFG_target_network_information_UDP(2, 2, asio::ip::address_v4::from_string(
+            manager->CFG_target_network_information_UDP(2, SEM_DATA_ID, asio::ip::address_v4::from_string(
                 *slaveDescription1->TransportProtocols.UDP_IPv4->Control->host).to_ulong(), port1);
             std::cout << "SlaveID=2 Target Network Informations" << std::endl;
             numOfCmd[2] = 6;
@@ -264,6 +268,14 @@ private:
 
     void logAck(uint8_t sender, uint16_t pduSeqId, std::shared_ptr<std::vector<LogEntry>> entries);
 
+    //Collegamenti tra slave: ogni data_id trasporta un output verso l'input corrispondente
+    //POS_DATA_ID: SumoPos (slave 1) in uscita
+    //SEM_DATA_ID: RngSemVal (slave 2) -> SumoSemValue (slave 1)
+    static constexpr uint16_t POS_DATA_ID = 1;
+    static constexpr uint16_t SEM_DATA_ID = 2;
+    static_assert(std::is_same<RngSemVal::type, SumoSemValue::type>::value,
+                  "RngSemVal e SumoSemValue sono collegati da SEM_DATA_ID e devono avere lo stesso tipo");
+
     OstreamLog stdLog;
 
     uint8_t maxInitRuns = 0;
@@ -0,0 +1,12 @@
+#ifndef RNG_IO_H_
+#define RNG_IO_H_
+
+#include "../common/dcp-variables.hpp"
+
+//Variabili dello slave RNG, condivise con il master per la configurazione
+
+struct RngSemVal : SlaveOutput<2, uint8_t> {
+    static constexpr const char* name = "sem_val";
+};
+
+#endif /* RNG_IO_H_ */
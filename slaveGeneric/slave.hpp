@@ -16,6 +16,11 @@
 #include <random>
 #include <iostream>
 
+#include "rng-io.hpp"
+#include "../common/dcp-slave-io.hpp"
+
+typedef DcpSlaveIO<RngSemVal> RngIO;
+
 class Slave {
 public:
     Slave() : stdLog(std::cout) {
@@ -47,7 +52,7 @@ public:
             std::bind(&OstreamLog::logOstream, stdLog, std::placeholders::_1));
         manager->setGenerateLogString(true);
         std::cout << "Creazione del file xml" << std::endl;
-        writeDcpSlaveDescription(slaved, "randomRNGSlave.xml");
+        RngIO::writeXml(slaved, "randomRNGSlave.xml");
     }
 
     ~Slave() {
@@ -61,13 +66,13 @@ public:
         simulationTime = 0;
         currentStep = 0;
 
-        a = manager->getOutput<uint8_t *>(a_vr);
-        *a = 0;
+        io.bind(manager);
+        io.get<RngSemVal>() = 0;
     }
 
     void initialize() {
         std::cout << "Inizializzazione..." << std::endl;
-        *a = 0;
+        io.get<RngSemVal>() = 0;
     }
 
     void doStep(uint64_t steps) {
@@ -88,8 +93,9 @@ public:
         } else {
             current_distance = 1;
         }
-        *a=current_value;
-        std::cout << "[ "<< timeDiff <<" ]" << "Nuovo valore pseudorandomico: "<< std::to_string(*a) << std::endl;
+        uint8_t& a = io.get<RngSemVal>();
+        a=current_value;
+        std::cout << "[ "<< timeDiff <<" ]" << "Nuovo valore pseudorandomico: "<< std::to_string(a) << std::endl;
         simulationTime += timeDiff;
         currentStep += steps;
     }
@@ -129,10 +135,7 @@ public:
         slaveDescription.CapabilityFlags.canProvideLogOnRequest = true;
         slaveDescription.CapabilityFlags.canProvideLogOnNotification = true;
         std::cout << "--Gestione I/O" << std::endl;
-        std::shared_ptr<Output_t> caus_y = make_Output_ptr<uint8_t>();
-        std::cout << "--A" << std::endl;
-        slaveDescription.Variables.push_back(make_Variable_output("sem_val", a_vr, caus_y));
-        std::cout << "--C" << std::endl;
+        RngIO::describe(slaveDescription);
         slaveDescription.Log = make_Log_ptr();
         std::cout << "--D" << std::endl;
         slaveDescription.Log->categories.push_back(make_Category(1, "DCP_SLAVE"));
@@ -162,8 +165,7 @@ private:
         "[Time = %float64]: Random value is: %uint8",
         {DcpDataType::float64, DcpDataType::uint8});
 
-    uint8_t *a;
-    const uint32_t a_vr = 2;
+    RngIO io;
 
 
     int current_value=2;
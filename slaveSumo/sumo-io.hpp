@@ -0,0 +1,30 @@
+#ifndef SUMO_IO_H_
+#define SUMO_IO_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/dcp-variables.hpp"
+
+//Variabili dello slave SUMO, condivise con il master per la configurazione
+
+//Posizioni dei veicoli nel formato id#posx#posy@id2#posx2#posy2 ...
+struct SumoPos : SlaveOutput<1, DcpString> {
+    static constexpr const char* name = "pos";
+    static void describe(std::shared_ptr<Output_t>& caus) {
+        caus->String->maxSize = std::make_shared<uint32_t>(9999);
+        caus->String->start = std::make_shared<std::string>(" ");
+    }
+};
+
+//Valore del generatore pseudocasuale, se >= 128 viene chiuso un edge della rete
+struct SumoSemValue : SlaveInput<2, uint8_t> {
+    static constexpr const char* name = "sem_value";
+    static void describe(std::shared_ptr<CommonCausality_t>& caus) {
+        caus->Uint8->start = std::make_shared<std::vector<uint8_t>>();
+        caus->Uint8->start->push_back(0);
+    }
+};
+
+#endif /* SUMO_IO_H_ */
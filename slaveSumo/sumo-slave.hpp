@@ -18,6 +18,13 @@
 #include <libsumo/libsumo.h>
 #include <libsumo/libtraci.h>
 
+#include "vehicle-table.hpp"
+#include "sumo-io.hpp"
+#include "../common/dcp-slave-io.hpp"
+#include "../common/phase-profiler.hpp"
+
+
+typedef DcpSlaveIO<SumoPos, SumoSemValue> SumoIO;
 
 class Slave {
 private:
@@ -42,16 +49,26 @@ private:
             "[Time = %float64]: sin(%uint64 + %float64) = %float64",
             {DcpDataType::float64, DcpDataType::uint64, DcpDataType::float64, DcpDataType::float64});
 
-    char* pos;
-    DcpString* posStr;
-    const uint32_t pos_vr = 1;
-
-    uint8_t* sem_value;
-    const uint32_t sem_vr = 2;
+    SumoIO io;
 
     std::vector<std::string> edgeIDs;
     std::string old_id = "";
 
+    VehicleTable vehicles;
+    std::string outputString;
+
+    //FASI DEL doStep MISURATE DAL PROFILER
+    //(attivo se SUMO_SLAVE_PROFILE contiene il percorso del trace, in quel caso attivabile/disattivabile a runtime con SIGUSR1)
+    PhaseProfiler& profiler = PhaseProfiler::instance();
+    const PhaseProfiler::phase_t PH_DO_STEP = profiler.registerPhase("doStep");
+    const PhaseProfiler::phase_t PH_SIM_STEP = profiler.registerPhase("Simulation::step");
+    const PhaseProfiler::phase_t PH_ID_LIST = profiler.registerPhase("departed/arrived/teleport");
+    const PhaseProfiler::phase_t PH_POSITIONS = profiler.registerPhase("getPosition");
+    const PhaseProfiler::phase_t PH_STRING_BUILD = profiler.registerPhase("string build");
+    const PhaseProfiler::phase_t PH_SET_STRING = profiler.registerPhase("setString");
+    const PhaseProfiler::phase_t PH_EDGE_CLOSURE = profiler.registerPhase("edge closure");
+    const PhaseProfiler::phase_t PH_REROUTE = profiler.registerPhase("rerouteTraveltime");
+
 
 
 
@@ -60,7 +77,8 @@ public:
     Slave() : stdLog(std::cout) {
         udpDriver = new UdpDriver(HOST, PORT);
         std::cout << "Gestione dello SlaveDescription" << std::endl;
-        manager = new DcpManagerSlave(getSlaveDescription(), udpDriver->getDcpDriver());
+        SlaveDescription_t slaved = getSlaveDescription();
+        manager = new DcpManagerSlave(slaved, udpDriver->getDcpDriver());
         manager->setInitializeCallback<SYNC>(
                 std::bind(&Slave::initialize, this));
         manager->setConfigureCallback<SYNC>(
@@ -74,12 +92,21 @@ public:
         manager->setTimeResListener<SYNC>(std::bind(&Slave::setTimeRes, this,
                                                     std::placeholders::_1,
                                                     std::placeholders::_2));
+        manager->setStopCallback<SYNC>(
+                std::bind(&Slave::stop, this));
 
         //Display log messages on console
         manager->addLogListener(
                 std::bind(&OstreamLog::logOstream, stdLog, std::placeholders::_1));
         manager->setGenerateLogString(true);
+        std::cout << "Creazione del file xml" << std::endl;
+        SumoIO::writeXml(slaved, "slavesumodesc.xml");
 
+        //SIGUSR1 viene intercettato solo se il profiling e' configurato, altrimenti resta l'azione di default
+        if (profiler.enableFromEnv("SUMO_SLAVE_PROFILE")) {
+                std::cout << "Profiler delle fasi attivo, trace in " << profiler.getTracePath() << std::endl;
+                PhaseProfiler::installToggleSignal(SIGUSR1);
+        }
     }
 
     ~Slave() {
@@ -93,9 +120,7 @@ public:
         simulationTime = 0;
         currentStep = 0;
 
-        sem_value = manager->getInput<uint8_t *>(sem_vr);
-        pos = manager->getOutput<char*>(pos_vr);
-        posStr = new DcpString(pos);
+        io.bind(manager);
 
 
         std::cout << "Inizio connessione a SUMO" << std::endl;
@@ -107,51 +132,78 @@ public:
         //OTTENIAMO GLI EDGE DELLA RETE
         std::cout << "Ottenimento topologia mappa" << std::endl;
         edgeIDs = libsumo::Edge::getIDList();
+        //VEICOLI GIA' PRESENTI DOPO IL PRIMO STEP, DA QUI IN POI LA TABELLA E' INCREMENTALE
+        vehicles.seed();
         std::cout << "Done!" << std::endl;
     }
 
     void initialize() {
         std::string str("");
-        posStr->setString(str);
+        io.get<SumoPos>().setString(str);
     }
 
     void doStep(uint64_t steps) {
+        PhaseProfiler::Scope stepScope(PH_DO_STEP);
         float64_t timeDiff =
                 ((double) numerator) / ((double) denominator) * ((double) steps);
 
         //STEP SUMO
         std::cout<<"Inizio step SUMO"<<std::endl;
-        libsumo::Simulation::step(100);
+        {
+                PhaseProfiler::Scope scope(PH_SIM_STEP);
+                libsumo::Simulation::step(100);
+        }
 
-        //OTTENIAMO I VEICOLI PRESENTI IN SIMULAZIONE
-        std::vector<std::string> vehicleIDs = libsumo::Vehicle::getIDList();
+        //AGGIORNIAMO LA TABELLA DEI VEICOLI CON PARTENZE E ARRIVI DELLO STEP
+        {
+                PhaseProfiler::Scope scope(PH_ID_LIST);
+                vehicles.update();
+        }
+        {
+                PhaseProfiler::Scope scope(PH_POSITIONS);
+                vehicles.refresh();
+        }
 
         //ITERIAMO SUI VEICOLI E OTTENIAMO LE POSIZIONI
         //per semplicità e per esempio della classe DcpString userò una stringa
         //del tipo id#posx#posy@id2#posx2#posy2 ...
-        std::string outputString = "";
-        for (const auto& id : vehicleIDs) {
-                std::cout<<"Iterazione sul veicolo con ID: "<< id <<std::endl;
-                double posx = libsumo::Vehicle::getPosition(id, false).x;
-                double posy = libsumo::Vehicle::getPosition(id, false).y;
-                std::string tmp = id + "#" + std::to_string(posx) + "#" + std::to_string(posy) + "@";
-                outputString += tmp;
+        {
+                PhaseProfiler::Scope scope(PH_STRING_BUILD);
+                outputString.clear();
+                for (VehicleTable::handle_t h = 0; h < vehicles.size(); h++) {
+                        outputString += vehicles.ids()[h];
+                        outputString += '#';
+                        outputString += std::to_string(vehicles.x()[h]);
+                        outputString += '#';
+                        outputString += std::to_string(vehicles.y()[h]);
+                        outputString += '@';
+                }
         }
 
-        posStr -> setString(outputString);
+        {
+                PhaseProfiler::Scope scope(PH_SET_STRING);
+                io.get<SumoPos>().setString(outputString);
+        }
 
-        if(*sem_value >= 128){
+        const uint8_t sem_value = io.get<SumoSemValue>();
+        if(sem_value >= 128){
                 std::cout << "Cambio edge del network" << std::endl;
-                int random_index = *sem_value%edgeIDs.size();
+                int random_index = sem_value%edgeIDs.size();
                 std::string newRand = edgeIDs[random_index];
                 std::cout << "Edge con id " << newRand << "Ora inaccessibile, Ripristino dell'edge con id "<<old_id << std::endl;
-                libsumo::Edge::setMaxSpeed(newRand, 0.0);
-                //RIPRISTINO VECCHIO EDGE FERMO
-                if(old_id!=""){libsumo::Edge::setMaxSpeed(old_id, 30.0);}
+                {
+                        PhaseProfiler::Scope scope(PH_EDGE_CLOSURE);
+                        libsumo::Edge::setMaxSpeed(newRand, 0.0);
+                        //RIPRISTINO VECCHIO EDGE FERMO
+                        if(old_id!=""){libsumo::Edge::setMaxSpeed(old_id, 30.0);}
+                }
                 old_id=newRand;
                 //REROUTING DATO EDGE FERMO
-                for (const auto& id : vehicleIDs) {
-                        libsumo::Vehicle::rerouteTraveltime(id);
+                {
+                        PhaseProfiler::Scope scope(PH_REROUTE);
+                        for (const auto& id : vehicles.ids()) {
+                                libsumo::Vehicle::rerouteTraveltime(id);
+                        }
                 }
 
         }
@@ -161,6 +213,20 @@ public:
         currentStep += steps;
     }
 
+    //A fine simulazione esportiamo il trace delle fasi e la tabella riassuntiva,
+    //poi azzeriamo il profiler cosi' che un run successivo ad un reset venga misurato da solo
+    void stop() {
+        if (!profiler.hasRecords()) {
+                return;
+        }
+        std::cout << "Riepilogo fasi del doStep" << std::endl;
+        profiler.printSummary(std::cout);
+        if (profiler.writeChromeTrace(profiler.getTracePath())) {
+                std::cout << "Trace delle fasi scritto in " << profiler.getTracePath() << std::endl;
+        }
+        profiler.reset();
+    }
+
     void setTimeRes(const uint32_t numerator, const uint32_t denominator) {
         this->numerator = numerator;
         this->denominator = denominator;
@@ -195,17 +261,8 @@ public:
         slaveDescription.CapabilityFlags.canProvideLogOnRequest = true;
         slaveDescription.CapabilityFlags.canProvideLogOnNotification = true;
 
-        std::cout << "--Gestione dei pointer per gli output" << std::endl;
-        std::shared_ptr<Output_t> caus_pos = make_Output_String_ptr();
-		caus_pos->String->maxSize = std::make_shared<uint32_t>(9999);
-		caus_pos->String->start = std::make_shared<std::string>(" ");
-        slaveDescription.Variables.push_back(make_Variable_output("pos", pos_vr, caus_pos));
-        std::cout << "--Gestione dei pointer per gli input" << std::endl;
-        std::shared_ptr<CommonCausality_t> caus_a =
-                make_CommonCausality_ptr<uint8_t>();
-        caus_a->Uint8->start = std::make_shared<std::vector<uint8_t>>();
-        caus_a->Uint8->start->push_back(0);
-        slaveDescription.Variables.push_back(make_Variable_input("sem_value", sem_vr, caus_a));
+        std::cout << "--Gestione I/O" << std::endl;
+        SumoIO::describe(slaveDescription);
         slaveDescription.Log = make_Log_ptr();
         slaveDescription.Log->categories.push_back(make_Category(1, "DCP_SLAVE"));
         std::cout << "--SlaveDescription creato" << std::endl;
@@ -0,0 +1,121 @@
+#ifndef VEHICLE_TABLE_H_
+#define VEHICLE_TABLE_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <libsumo/libsumo.h>
+
+//Tabella persistente dei veicoli presenti sulla rete.
+//Ogni ID stringa viene internato una sola volta e associato ad un handle intero denso,
+//le posizioni dei veicoli sono memorizzate per colonne (structure-of-arrays) cosi' che
+//serializzazione e rerouting scorrano array contigui invece di fare hashing di stringhe.
+//La tabella viene mantenuta in modo incrementale e contiene gli stessi veicoli di
+//Vehicle::getIDList: partenze e fine teleport aggiungono una riga, inizio teleport e
+//arrivi la rimuovono.
+class VehicleTable {
+public:
+    typedef uint32_t handle_t;
+
+    //Popola la tabella con i veicoli gia' presenti (da chiamare una sola volta dopo l'avvio di SUMO)
+    void seed() {
+        clear();
+        for (const auto& id : libsumo::Vehicle::getIDList()) {
+            insert(id);
+        }
+    }
+
+    //Applica le variazioni dell'ultimo Simulation::step, che puo' coprire piu' step interni.
+    //Prima si rimuovono i veicoli entrati in teleport, poi si aggiungono partenze e fine teleport,
+    //infine si rimuovono gli arrivi: un veicolo che inizia e termina un teleport nello stesso
+    //intervallo resta nella tabella. Se invece e' di nuovo in teleport, refresh() lo scarta
+    //perche' la sua posizione non e' valida.
+    void update() {
+        for (const auto& id : libsumo::Simulation::getStartingTeleportIDList()) {
+            erase(id);
+        }
+        for (const auto& id : libsumo::Simulation::getDepartedIDList()) {
+            insert(id);
+        }
+        for (const auto& id : libsumo::Simulation::getEndingTeleportIDList()) {
+            insert(id);
+        }
+        for (const auto& id : libsumo::Simulation::getArrivedIDList()) {
+            erase(id);
+        }
+    }
+
+    //Aggiorna le posizioni, una sola chiamata a SUMO per veicolo.
+    //Per sicurezza le righe con posizione non valida (veicolo fuori dalla rete) vengono rimosse.
+    void refresh() {
+        handle_t h = 0;
+        while (h < size()) {
+            const libsumo::TraCIPosition p = libsumo::Vehicle::getPosition(idColumn[h], false);
+            if (p.x == libsumo::INVALID_DOUBLE_VALUE || p.y == libsumo::INVALID_DOUBLE_VALUE) {
+                eraseRow(h);
+                continue;
+            }
+            xColumn[h] = p.x;
+            yColumn[h] = p.y;
+            h++;
+        }
+    }
+
+    void clear() {
+        index.clear();
+        idColumn.clear();
+        xColumn.clear();
+        yColumn.clear();
+    }
+
+    handle_t size() const { return static_cast<handle_t>(idColumn.size()); }
+
+    //Colonne in sola lettura, una riga per veicolo. Gli handle coincidono con l'indice di riga
+    //e restano validi fino alla prossima update/refresh.
+    const std::vector<std::string>& ids() const { return idColumn; }
+    const std::vector<double>& x() const { return xColumn; }
+    const std::vector<double>& y() const { return yColumn; }
+
+private:
+    void insert(const std::string& id) {
+        if (index.find(id) != index.end()) {
+            return;
+        }
+        index.emplace(id, size());
+        idColumn.push_back(id);
+        xColumn.push_back(0.0);
+        yColumn.push_back(0.0);
+    }
+
+    void erase(const std::string& id) {
+        auto it = index.find(id);
+        if (it != index.end()) {
+            eraseRow(it->second);
+        }
+    }
+
+    //Rimozione swap-and-pop: l'ultima riga prende il posto di quella rimossa
+    void eraseRow(handle_t h) {
+        const handle_t last = size() - 1;
+        index.erase(idColumn[h]);
+        if (h != last) {
+            idColumn[h] = std::move(idColumn[last]);
+            xColumn[h] = xColumn[last];
+            yColumn[h] = yColumn[last];
+            index[idColumn[h]] = h;
+        }
+        idColumn.pop_back();
+        xColumn.pop_back();
+        yColumn.pop_back();
+    }
+
+    std::unordered_map<std::string, handle_t> index;
+
+    std::vector<std::string> idColumn;
+    std::vector<double> xColumn;
+    std::vector<double> yColumn;
+};
+
+#endif /* VEHICLE_TABLE_H_ */